@@ -11,6 +11,7 @@
 #include <string_view>
 #include <set>
 #include <filesystem>
+#include <charconv>
 
 using namespace mitus;
 namespace fs = std::filesystem;
@@ -26,6 +27,7 @@ class MapBuilder {
     // avoid costly string objects by using a single pool
     std::string string_pool;
     std::set<std::string> country_prefixes;
+    std::array<LengthRule, CC_TABLE_SIZE> length_rules{};
 
     int32_t add_to_pool(std::string_view s) {
         if (s.empty()) return -1;
@@ -51,7 +53,59 @@ class MapBuilder {
         return curr;
     }
 
+    // turn a list like "7,9-10" into a bitmask, 0 if malformed or any value is above max
+    static uint16_t parse_mask(std::string_view spec, int max) {
+        uint16_t mask = 0;
+        while (!spec.empty()) {
+            const auto comma = spec.find(',');
+            const std::string_view item = spec.substr(0, comma);
+            spec = (comma == std::string_view::npos) ? std::string_view{} : spec.substr(comma + 1);
+
+            const auto dash = item.find('-');
+            const std::string_view lo_s = item.substr(0, dash);
+            const std::string_view hi_s = (dash == std::string_view::npos) ? lo_s : item.substr(dash + 1);
+            int lo = -1, hi = -1;
+            if (std::from_chars(lo_s.data(), lo_s.data() + lo_s.size(), lo).ec != std::errc{} ||
+                std::from_chars(hi_s.data(), hi_s.data() + hi_s.size(), hi).ec != std::errc{}) return 0;
+            if (lo < 0 || hi > max || lo > hi) return 0;
+
+            for (int n = lo; n <= hi; ++n) mask |= static_cast<uint16_t>(1u << n);
+        }
+        return mask;
+    }
+
 public:
+    // parse possible national number lengths (and leading digits) per calling code
+    void load_lengths(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) return;
+
+        for (std::string line; std::getline(file, line); ) {
+            if (line.empty() || line[0] == '#') continue;
+            const std::string_view l = line;
+            const auto p = l.find('|');
+            if (p == std::string_view::npos) continue;
+
+            const std::string_view code = l.substr(0, p);
+            std::string_view lengths = l.substr(p + 1);
+            std::string_view leading = "0-9";
+            if (const auto q = lengths.find('|'); q != std::string_view::npos) {
+                leading = lengths.substr(q + 1);
+                lengths = lengths.substr(0, q);
+            }
+
+            size_t cc = 0;
+            const auto res = std::from_chars(code.data(), code.data() + code.size(), cc);
+            const LengthRule rule{parse_mask(lengths, 15), parse_mask(leading, 9)};
+            if (res.ec != std::errc{} || res.ptr != code.data() + code.size() || cc == 0 || cc >= CC_TABLE_SIZE ||
+                rule.lengths == 0 || rule.lead_digits == 0) {
+                std::cerr << "Skipping malformed length rule: " << line << "\n";
+                continue;
+            }
+            length_rules[cc] = rule;
+        }
+    }
+
 // parse geo+tz info from dataset
     void load_data(LiveNode& root, const std::string& path, bool is_tz) {
         std::ifstream file(path);
@@ -124,6 +178,7 @@ public:
         uint32_t crc = 0xFFFFFFFF;
         crc = calculate_crc32(flat_nodes.data(), flat_nodes.size() * sizeof(StaticNode), crc);
         crc = calculate_crc32(flat_records.data(), flat_records.size() * sizeof(MetadataRecord), crc);
+        crc = calculate_crc32(length_rules.data(), length_rules.size() * sizeof(LengthRule), crc);
         crc = calculate_crc32(string_pool.data(), string_pool.size(), crc);
         
         FileHeader head{};
@@ -137,6 +192,7 @@ public:
         out.write(reinterpret_cast<const char*>(&head), sizeof(head));
         out.write(reinterpret_cast<const char*>(flat_nodes.data()), flat_nodes.size() * sizeof(StaticNode));
         out.write(reinterpret_cast<const char*>(flat_records.data()), flat_records.size() * sizeof(MetadataRecord));
+        out.write(reinterpret_cast<const char*>(length_rules.data()), length_rules.size() * sizeof(LengthRule));
         out.write(string_pool.data(), string_pool.size());
     }
 };
@@ -169,6 +225,8 @@ int main() {
     builder.load_data(root, "resources/timezones/map_data.txt", true);
     builder.load_data(root, "resources/timezones/custom_tz.txt", true);
 
+    builder.load_lengths("resources/metadata/possible_lengths.txt");
+
     builder.flatten(root, "mitu.db");
     return 0;
 }
\ No newline at end of file
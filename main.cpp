@@ -10,6 +10,10 @@
 #include <cstring>
 #include <unordered_map>
 #include <limits>
+#include <algorithm>
+#include <bit>
+#include <span>
+#include <vector>
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -26,6 +30,21 @@ using namespace mitus;
 
 enum class TimeFormat { H12, H24 };
 
+// result of checking a sanitized number against the per calling code length rules
+enum class NumberCheck : uint8_t { Valid, InvalidCountryCode, TooShort, TooLong, InvalidLength, InvalidPrefix };
+
+constexpr std::string_view describe(NumberCheck result) {
+    switch (result) {
+        case NumberCheck::Valid: return "valid";
+        case NumberCheck::InvalidCountryCode: return "unknown country code";
+        case NumberCheck::TooShort: return "too short for its country code";
+        case NumberCheck::TooLong: return "too many digits";
+        case NumberCheck::InvalidLength: return "impossible length for its country code";
+        case NumberCheck::InvalidPrefix: return "impossible leading digit after the country code";
+    }
+    return "unknown";
+}
+
 class MappedFile {
     void* addr_{nullptr};
      size_t size_{0};
@@ -84,11 +103,13 @@ class mituEngine {
     std::unique_ptr<MappedFile> file_;
     const StaticNode* nodes_{nullptr};
     const MetadataRecord* recs_{nullptr};
+    const LengthRule* rules_{nullptr};
     const char* pool_{nullptr};
 
     uint32_t node_count_{0};
     uint32_t record_count_{0};
     size_t pool_size_{0};
+    bool has_length_rules_{false}; // false if atlas was built without length metadata
 
     TimeFormat time_format_{TimeFormat::H24}; // default to 24h
     bool measure_performance_{true}; // output operation time in ms for each lookup
@@ -110,7 +131,8 @@ public:
     void setTimeFormat(TimeFormat fmt) { time_format_ = fmt; }
     void setMeasurePerformance(bool measure) { measure_performance_ = measure; }
 
-    bool init(const std::string& path) {
+    // skip precaching timezones when only check() or prefilter() will be used
+    bool init(const std::string& path, bool precache_tz = true) {
         file_ = std::make_unique<MappedFile>(path);
         if (!file_->valid()) return false;
 
@@ -160,28 +182,46 @@ public:
 
         const size_t nodes_size = static_cast<size_t>(node_count_) * sizeof(StaticNode);
         const size_t recs_size = static_cast<size_t>(record_count_) * sizeof(MetadataRecord);
+        constexpr size_t rules_size = CC_TABLE_SIZE * sizeof(LengthRule);
         
         if (std::numeric_limits<size_t>::max() - sizeof(FileHeader) < nodes_size ||
-        std::numeric_limits<size_t>::max() - (sizeof(FileHeader) + nodes_size) < recs_size) {
+        std::numeric_limits<size_t>::max() - (sizeof(FileHeader) + nodes_size) < recs_size ||
+        std::numeric_limits<size_t>::max() - (sizeof(FileHeader) + nodes_size + recs_size) < rules_size) {
             return false;
         }
 
-        const size_t required_min = sizeof(FileHeader) + nodes_size + recs_size;
+        const size_t required_min = sizeof(FileHeader) + nodes_size + recs_size + rules_size;
 
         if (required_min > fileSize || node_count_ == 0) return false;
 
         const char* base = static_cast<const char*>(file_->data());
         nodes_ = reinterpret_cast<const StaticNode*>(base + sizeof(FileHeader));
         recs_ = reinterpret_cast<const MetadataRecord*>(base + sizeof(FileHeader) + nodes_size);
+        rules_ = reinterpret_cast<const LengthRule*>(base + sizeof(FileHeader) + nodes_size + recs_size);
         pool_ = base + required_min;
         pool_size_ = fileSize - required_min;
 
+        for (size_t i = 0; i < CC_TABLE_SIZE; ++i) {
+            if (rules_[i].lengths != 0) {
+                has_length_rules_ = true;
+                break;
+            }
+        }
+
         #ifdef _WIN32
         QueryPerformanceFrequency(&qpc_freq_);
+        #endif
+
+        if (precache_tz) precache_timezones();
+        return true;
+    }
+
+    // pre-cache timezone pointers for faster lookups
+    void precache_timezones() {
+        #ifdef _WIN32
         const auto now = std::chrono::system_clock::now();
         #endif
 
-        // pre-cache timezone pointers for faster lookups
         for (uint32_t i = 0; i < record_count_; ++i) {
             const auto& rec = recs_[i];
             if (rec.tz_off != -1) {
@@ -203,7 +243,53 @@ public:
                 }
             }
         }
-        return true;
+    }
+
+    // reject numbers that can't exist before touching the trie, records, pool or timezones
+    [[nodiscard]] NumberCheck check(std::string_view num) const noexcept {
+        // we are starting w/ sanitized num, E.164 max length is 15 digits
+        if (num.length() > 15) return NumberCheck::TooLong;
+        if (!has_length_rules_) return NumberCheck::Valid;
+
+        // calling codes are prefix free, so the first assigned 1-3 digit prefix is the country code
+        size_t cc = 0;
+        size_t cc_len = 0;
+        const size_t max_cc_len = std::min<size_t>(num.length(), 3);
+        for (size_t i = 0; i < max_cc_len; ++i) {
+            const unsigned digit = static_cast<unsigned>(num[i] - '0');
+            if (digit > 9) return NumberCheck::InvalidCountryCode;
+            cc = cc * 10 + digit;
+            if (rules_[cc].lengths != 0) {
+                cc_len = i + 1;
+                break;
+            }
+        }
+        if (cc_len == 0) return NumberCheck::InvalidCountryCode;
+
+        const LengthRule rule = rules_[cc];
+        const size_t nsn_len = num.length() - cc_len;
+        if (nsn_len == 0) return NumberCheck::TooShort;
+
+        const unsigned lead = static_cast<unsigned>(num[cc_len] - '0');
+        const unsigned length_ok = (rule.lengths >> nsn_len) & 1u;
+        const unsigned lead_ok = (lead <= 9) ? (rule.lead_digits >> lead) & 1u : 0u;
+        if (length_ok & lead_ok) return NumberCheck::Valid;
+
+        if (length_ok) return NumberCheck::InvalidPrefix;
+        if (nsn_len < static_cast<size_t>(std::countr_zero(rule.lengths))) return NumberCheck::TooShort;
+        if (nsn_len >= static_cast<size_t>(std::bit_width(rule.lengths))) return NumberCheck::TooLong;
+        return NumberCheck::InvalidLength;
+    }
+
+    // batch pre-filter, writes one result per number and returns how many are valid
+    size_t prefilter(std::span<const std::string_view> nums, std::span<NumberCheck> results) const noexcept {
+        const size_t n = std::min(nums.size(), results.size());
+        size_t valid = 0;
+        for (size_t i = 0; i < n; ++i) {
+            results[i] = check(nums[i]);
+            valid += (results[i] == NumberCheck::Valid);
+        }
+        return valid;
     }
 
     void lookup(std::string_view num) const {
@@ -235,9 +321,8 @@ public:
 
         // PERFORMANCE MEASUREMENT END
 
-        // we are starting w/ sanitized num, E.164 max length is 15 digits
-        if (num.length() > 15) {
-            std::cerr << "Error: Not a valid number (greater than 15 digits).\n";
+        if (const auto result = check(num); result != NumberCheck::Valid) {
+            std::cerr << "Error: Not a valid number (" << describe(result) << ").\n";
             return;
         }
         
@@ -355,12 +440,62 @@ public:
     }
 };
 
+// keep digits only and skip leading zeros
+static void append_digits(std::string_view src, std::string& out) {
+    for (char c : src) {
+        if (std::isdigit(static_cast<unsigned char>(c))) {
+            if (out.empty() && c == '0') continue;
+            out += c;
+        }
+    }
+}
+
+// batch pre-filter: read one number per line from stdin, print only numbers that could exist
+static int run_filter() {
+    mituEngine engine;
+    if (!engine.init("mitu.db", false)) {
+        std::cerr << "Error: Could not initialize mitu.db\n";
+        return 1;
+    }
+
+    constexpr size_t batch_size = 4096;
+    std::vector<std::string> batch;
+    std::vector<std::string_view> views;
+    std::vector<NumberCheck> results(batch_size);
+    batch.reserve(batch_size);
+    views.reserve(batch_size);
+
+    auto flush = [&] {
+        views.assign(batch.begin(), batch.end());
+        engine.prefilter(views, results);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (results[i] == NumberCheck::Valid) std::cout << '+' << batch[i] << '\n';
+        }
+        batch.clear();
+    };
+
+    for (std::string line; std::getline(std::cin, line); ) {
+        std::string_view num = line;
+        num.remove_prefix(std::min(num.find_first_not_of(" \t"), num.size()));
+        // same rules as single lookups, a '+' is required and letters are refused
+        if (num.empty() || num[0] != '+') continue;
+        if (std::any_of(num.begin(), num.end(), [](char c) { return std::isalpha(static_cast<unsigned char>(c)); })) continue;
+
+        std::string sanitized;
+        append_digits(num, sanitized);
+        batch.push_back(std::move(sanitized));
+        if (batch.size() == batch_size) flush();
+    }
+    flush();
+    return 0;
+}
+
 int main(int argc, char** argv) {
     std::ios_base::sync_with_stdio(false);
     std::cin.tie(NULL);
 
     if (argc < 2) {
-        std::cout << "Usage: ./mitu <phone_number> or --version\n";
+        std::cout << "Usage: ./mitu <phone_number>, --filter or --version\n";
         return 1;
     }
 
@@ -372,6 +507,10 @@ int main(int argc, char** argv) {
         return 0;
     }
 
+    if (arg == "--filter" || arg == "-f") {
+        return run_filter();
+    }
+
     for (char c : arg) {
         if (std::isalpha(static_cast<unsigned char>(c))) {
             std::cerr << "Error: Not a valid phone number (contains letters).\n";
@@ -385,20 +524,8 @@ int main(int argc, char** argv) {
     }
 
     std::string sanitized;
-    bool leading_zeros = true; // assume there may be leading zeros
-
     for (int i = 1; i < argc; ++i) {
-        for (char c : std::string_view(argv[i])) {
-            // skip non-digit chars
-            if (std::isdigit(static_cast<unsigned char>(c))) {
-                // skip leading zeros
-                if (leading_zeros && c == '0') {
-                    continue;
-                }
-                leading_zeros = false;
-                sanitized += c;
-            }
-        }
+        append_digits(argv[i], sanitized);
     }
 
     mituEngine engine;
@@ -407,12 +534,19 @@ int main(int argc, char** argv) {
     engine.setTimeFormat(TimeFormat::H12);
     engine.setMeasurePerformance(measurePerformance);
 
-    if (engine.init("mitu.db")) {
-        engine.lookup(sanitized);
-    } else {
+    if (!engine.init("mitu.db", false)) {
         std::cerr << "Error: Could not initialize mitu.db\n";
         return 1;
     }
 
+    // discard impossible numbers before paying for the timezone cache
+    if (const auto result = engine.check(sanitized); result != NumberCheck::Valid) {
+        std::cerr << "Error: Not a valid number (" << describe(result) << ").\n";
+        return 1;
+    }
+
+    engine.precache_timezones();
+    engine.lookup(sanitized);
+
     return 0;
 }
\ No newline at end of file
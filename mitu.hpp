@@ -47,6 +47,15 @@ struct StaticNode {
     }
 };
 
+// calling codes are at most 3 digits, so index a flat table by their numeric value
+inline constexpr size_t CC_TABLE_SIZE = 1000;
+
+// possible national significant number lengths for a calling code, zeroed if unassigned
+struct LengthRule {
+    uint16_t lengths{0}; // bit n set if an n digit national number is possible
+    uint16_t lead_digits{0x3FF}; // bit d set if a national number may begin with d
+};
+
 struct FileHeader {
     uint32_t magic{0x4D495455}; // MITU
     uint32_t version{1}; // update if data structure changes
@@ -57,11 +66,13 @@ struct FileHeader {
 
 static_assert(sizeof(MetadataRecord) == 12, "MetadataRecord size mismatch");
 static_assert(sizeof(StaticNode) == 44, "StaticNode size mismatch");
+static_assert(sizeof(LengthRule) == 4, "LengthRule size mismatch");
 static_assert(sizeof(FileHeader) == 20, "FileHeader size mismatch");
 static_assert(std::is_standard_layout_v<MetadataRecord>, "MetadataRecord must be standard layout");
 static_assert(std::is_standard_layout_v<StaticNode>, "StaticNode must be standard layout");
 static_assert(std::is_trivially_copyable_v<MetadataRecord>, "MetadataRecord must be trivially copyable");
 static_assert(std::is_trivially_copyable_v<StaticNode>, "StaticNode must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<LengthRule>, "LengthRule must be trivially copyable");
 
 #pragma pack(pop)
 